@@ -3,6 +3,10 @@
 #include <string.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
 #define INF INT_MAX
 
 typedef struct {
@@ -46,6 +50,86 @@ typedef struct {
     HeapNode** array;
 } MinHeap;
 
+// Route field a shortest-path search minimises
+typedef enum {
+    WEIGHT_DISTANCE,
+    WEIGHT_COST,
+    WEIGHT_FLIGHTS
+} RouteWeight;
+
+// Shortest-path tables for routes that stay inside one region, indexed by
+// local airport number so each table is only as large as its region
+typedef struct {
+    int numLocal;
+    int localToGlobal[100];
+    int globalToLocal[100];  // -1 for airports outside the region
+    int* dist;               // numLocal x numLocal, row = source airport
+    int* duration;
+    int* cost;
+    int* prev;               // local number of the previous airport
+} RegionTables;
+
+// Query sent to a region worker, using network-wide airport indices
+typedef struct {
+    int from;
+    int to;
+} RegionRequest;
+
+// Best intra-region route for a RegionRequest. path lists the airports from
+// `from` to `to` inclusive, and length is 0 when there is no such route.
+typedef struct {
+    int distance;
+    int duration;
+    int cost;
+    int length;
+    int path[100];
+} RegionReply;
+
+// Regional split of a FlightNetwork. Each region's tables live in its own
+// worker process, reached over a Unix socket. The coordinator keeps only the
+// overlay graph of boundary airports (those with a route to or from another
+// region), linked by intra-region shortest paths and cross-region routes.
+typedef struct {
+    int numAirports;
+    int numShards;
+    int requestedShards;
+    int shardOf[100];
+    bool isBoundary[100];
+    pid_t workers[100];
+    int sockets[100];
+    FlightNetwork* overlay;
+} PartitionedNetwork;
+
+// Limits a customer can put on a route search
+typedef struct {
+    int maxStops;          // -1 for no limit
+    int maxCost;           // INF for no budget
+    bool excluded[100];    // airports the route must not pass through
+    bool excludedRoute[100][100];  // routes the route must not use, by [src][dest]
+} RouteConstraints;
+
+// A partial route in the constrained search. Labels are never freed during a
+// search, so a route is read back by following parent indices.
+typedef struct {
+    int airport;
+    int distance;
+    int duration;
+    int cost;
+    int hops;
+    int parent;            // index of the previous label, -1 at the source
+    int next;              // next label at the same airport, -1 at the end
+    int key;               // distance plus lower bound to the destination
+} RouteLabel;
+
+typedef struct {
+    RouteLabel* labels;
+    int numLabels;
+    int labelCapacity;
+    int* heap;             // label indices ordered by key
+    int heapSize;
+    int heapCapacity;
+} LabelQueue;
+
 // Forward declarations
 void freeNetwork(FlightNetwork* network);
 
@@ -220,48 +304,47 @@ void printPath(int* prev, int dest, FlightNetwork* network) {
     printf(" -> %s", network->airports[dest].code);
 }
 
-void dijkstra(FlightNetwork* network, int src, int dest) {
+// Run Dijkstra's algorithm from every airport whose dist label is already set.
+// dist sums the chosen route weight, while duration and cost always sum the
+// routes' own values. Airports with allowed[v] == false are never entered
+// (pass NULL to allow all), and the search stops once stopAt is settled
+// (pass -1 to settle everything).
+void runDijkstra(FlightNetwork* network, const bool* allowed, RouteWeight weight,
+                 int* dist, int* duration, int* cost, int* prev, int stopAt) {
     int V = network->numAirports;
 
-    int* dist = (int*)malloc(V * sizeof(int));
-    int* duration = (int*)malloc(V * sizeof(int));
-    int* cost = (int*)malloc(V * sizeof(int));
-
-    int* prev = (int*)malloc(V * sizeof(int));
-
     MinHeap* minHeap = createMinHeap(V);
 
     for (int v = 0; v < V; v++) {
-        dist[v] = INF;
-        duration[v] = INF;
-        cost[v] = INF;
-        prev[v] = -1;
-        minHeap->array[v] = createHeapNode(v, dist[v], duration[v], cost[v]);
+        minHeap->array[v] = createHeapNode(v, INF, INF, INF);
         minHeap->pos[v] = v;
     }
 
-    dist[src] = 0;
-    duration[src] = 0;
-    cost[src] = 0;
-    decreaseKey(minHeap, src, dist[src], duration[src], cost[src]);
-
     minHeap->size = V;
 
+    for (int v = 0; v < V; v++) {
+        if (dist[v] != INF)
+            decreaseKey(minHeap, v, dist[v], duration[v], cost[v]);
+    }
+
     while (!isEmpty(minHeap)) {
         HeapNode* minNode = extractMin(minHeap);
         int u = minNode->airport;
+        free(minNode);
 
-        if (u == dest)
+        if (u == stopAt || dist[u] == INF)
             break;
 
         AdjListNode* pCrawl = network->adjList[u];
         while (pCrawl != NULL) {
             int v = pCrawl->dest;
+            int w = weight == WEIGHT_COST ? pCrawl->cost :
+                    weight == WEIGHT_FLIGHTS ? 1 : pCrawl->distance;
 
-            if (isInMinHeap(minHeap, v) && dist[u] != INF &&
-                pCrawl->distance + dist[u] < dist[v]) {
+            if ((allowed == NULL || allowed[v]) && isInMinHeap(minHeap, v) &&
+                w + dist[u] < dist[v]) {
 
-                dist[v] = dist[u] + pCrawl->distance;
+                dist[v] = dist[u] + w;
                 duration[v] = duration[u] + pCrawl->duration;
                 cost[v] = cost[u] + pCrawl->cost;
 
@@ -271,9 +354,37 @@ void dijkstra(FlightNetwork* network, int src, int dest) {
             }
             pCrawl = pCrawl->next;
         }
+    }
 
-        free(minNode);
+    for (int i = 0; i < minHeap->size; i++) {
+        free(minHeap->array[i]);
     }
+    free(minHeap->array);
+    free(minHeap->pos);
+    free(minHeap);
+}
+
+void dijkstra(FlightNetwork* network, int src, int dest) {
+    int V = network->numAirports;
+
+    int* dist = (int*)malloc(V * sizeof(int));
+    int* duration = (int*)malloc(V * sizeof(int));
+    int* cost = (int*)malloc(V * sizeof(int));
+
+    int* prev = (int*)malloc(V * sizeof(int));
+
+    for (int v = 0; v < V; v++) {
+        dist[v] = INF;
+        duration[v] = INF;
+        cost[v] = INF;
+        prev[v] = -1;
+    }
+
+    dist[src] = 0;
+    duration[src] = 0;
+    cost[src] = 0;
+
+    runDijkstra(network, NULL, WEIGHT_DISTANCE, dist, duration, cost, prev, dest);
 
     if (dist[dest] == INF) {
         printf("No path exists from %s to %s\n",
@@ -292,14 +403,735 @@ void dijkstra(FlightNetwork* network, int src, int dest) {
     free(duration);
     free(cost);
     free(prev);
-    for (int i = 0; i < minHeap->capacity; i++) {
-        if (i < minHeap->size && minHeap->array[i]) {
-            free(minHeap->array[i]);
+}
+
+// Fill the tables for one region by running Dijkstra from each of its
+// airports without leaving the region
+void buildRegionTables(FlightNetwork* network, const int* shardOf, int shard,
+                       RegionTables* tables) {
+    int V = network->numAirports;
+
+    tables->numLocal = 0;
+    for (int v = 0; v < 100; v++) {
+        tables->globalToLocal[v] = -1;
+    }
+    for (int v = 0; v < V; v++) {
+        if (shardOf[v] == shard) {
+            tables->globalToLocal[v] = tables->numLocal;
+            tables->localToGlobal[tables->numLocal++] = v;
         }
     }
-    free(minHeap->array);
-    free(minHeap->pos);
-    free(minHeap);
+
+    int n = tables->numLocal;
+    tables->dist = (int*)malloc(n * n * sizeof(int));
+    tables->duration = (int*)malloc(n * n * sizeof(int));
+    tables->cost = (int*)malloc(n * n * sizeof(int));
+    tables->prev = (int*)malloc(n * n * sizeof(int));
+
+    bool inShard[100] = {false};
+    for (int v = 0; v < V; v++) {
+        inShard[v] = shardOf[v] == shard;
+    }
+
+    int* dist = (int*)malloc(V * sizeof(int));
+    int* duration = (int*)malloc(V * sizeof(int));
+    int* cost = (int*)malloc(V * sizeof(int));
+    int* prev = (int*)malloc(V * sizeof(int));
+
+    for (int i = 0; i < n; i++) {
+        int u = tables->localToGlobal[i];
+
+        for (int v = 0; v < V; v++) {
+            dist[v] = INF;
+            duration[v] = INF;
+            cost[v] = INF;
+            prev[v] = -1;
+        }
+
+        dist[u] = 0;
+        duration[u] = 0;
+        cost[u] = 0;
+
+        runDijkstra(network, inShard, WEIGHT_DISTANCE, dist, duration, cost, prev, -1);
+
+        for (int j = 0; j < n; j++) {
+            int v = tables->localToGlobal[j];
+            tables->dist[i * n + j] = dist[v];
+            tables->duration[i * n + j] = duration[v];
+            tables->cost[i * n + j] = cost[v];
+            tables->prev[i * n + j] = prev[v] == -1 ? -1 : tables->globalToLocal[prev[v]];
+        }
+    }
+
+    free(dist);
+    free(duration);
+    free(cost);
+    free(prev);
+}
+
+void freeRegionTables(RegionTables* tables) {
+    free(tables->dist);
+    free(tables->duration);
+    free(tables->cost);
+    free(tables->prev);
+}
+
+void answerRegionRequest(RegionTables* tables, RegionRequest* request, RegionReply* reply) {
+    int n = tables->numLocal;
+
+    reply->distance = INF;
+    reply->duration = INF;
+    reply->cost = INF;
+    reply->length = 0;
+
+    if (request->from < 0 || request->from >= 100 ||
+        request->to < 0 || request->to >= 100)
+        return;
+
+    int from = tables->globalToLocal[request->from];
+    int to = tables->globalToLocal[request->to];
+    if (from == -1 || to == -1 || tables->dist[from * n + to] == INF)
+        return;
+
+    reply->distance = tables->dist[from * n + to];
+    reply->duration = tables->duration[from * n + to];
+    reply->cost = tables->cost[from * n + to];
+
+    for (int v = to; v != -1; v = tables->prev[from * n + v]) {
+        reply->length++;
+    }
+
+    int i = reply->length;
+    for (int v = to; v != -1; v = tables->prev[from * n + v]) {
+        reply->path[--i] = tables->localToGlobal[v];
+    }
+}
+
+bool sendAll(int socket, const void* buffer, size_t size) {
+    const char* data = (const char*)buffer;
+    while (size > 0) {
+        ssize_t sent = send(socket, data, size, MSG_NOSIGNAL);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+bool recvAll(int socket, void* buffer, size_t size) {
+    char* data = (char*)buffer;
+    while (size > 0) {
+        ssize_t received = recv(socket, data, size, 0);
+        if (received <= 0)
+            return false;
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+// Body of a region worker process: build the region's tables, then answer
+// requests until the coordinator closes its end of the socket
+void runRegionWorker(FlightNetwork* network, const int* shardOf, int shard, int socket) {
+    RegionTables tables;
+    RegionRequest request;
+    RegionReply reply;
+
+    buildRegionTables(network, shardOf, shard, &tables);
+
+    while (recvAll(socket, &request, sizeof(request))) {
+        answerRegionRequest(&tables, &request, &reply);
+        if (!sendAll(socket, &reply, sizeof(reply)))
+            break;
+    }
+
+    freeRegionTables(&tables);
+    close(socket);
+}
+
+// Ask the worker for from's region for the best route to `to` that stays
+// inside that region
+bool queryRegion(PartitionedNetwork* partition, int from, int to, RegionReply* reply) {
+    RegionRequest request = {from, to};
+    int shard = partition->shardOf[from];
+
+    if (!sendAll(partition->sockets[shard], &request, sizeof(request)) ||
+        !recvAll(partition->sockets[shard], reply, sizeof(*reply))) {
+        printf("Error: Region %d worker is not responding\n", shard + 1);
+        reply->distance = INF;
+        reply->duration = INF;
+        reply->cost = INF;
+        reply->length = 0;
+        return false;
+    }
+    return true;
+}
+
+void freePartition(PartitionedNetwork* partition) {
+    for (int s = 0; s < partition->numShards; s++) {
+        close(partition->sockets[s]);
+        waitpid(partition->workers[s], NULL, 0);
+    }
+    if (partition->overlay != NULL) {
+        freeNetwork(partition->overlay);
+    }
+    free(partition);
+}
+
+// Split the network into at most numShards regions of roughly equal size by
+// growing each region breadth-first from an unassigned airport, start one
+// worker process per region, and build the boundary overlay graph.
+PartitionedNetwork* partitionNetwork(FlightNetwork* network, int numShards) {
+    int V = network->numAirports;
+
+    if (numShards < 1 || numShards > V) {
+        printf("Error: Number of regions must be between 1 and %d\n", V);
+        return NULL;
+    }
+
+    PartitionedNetwork* partition = (PartitionedNetwork*)malloc(sizeof(PartitionedNetwork));
+    partition->numAirports = V;
+    partition->numShards = 0;
+    partition->requestedShards = numShards;
+    partition->overlay = NULL;
+
+    // Routes are directed, but regions should follow connectivity either way
+    bool linked[100][100] = {{false}};
+    for (int u = 0; u < V; u++) {
+        for (AdjListNode* pCrawl = network->adjList[u]; pCrawl; pCrawl = pCrawl->next) {
+            linked[u][pCrawl->dest] = true;
+            linked[pCrawl->dest][u] = true;
+        }
+    }
+
+    for (int v = 0; v < V; v++) {
+        partition->shardOf[v] = -1;
+        partition->isBoundary[v] = false;
+    }
+
+    int target = (V + numShards - 1) / numShards;
+    int shard = 0, shardSize = 0;
+    int queue[100];
+
+    for (int seed = 0; seed < V; seed++) {
+        if (partition->shardOf[seed] != -1)
+            continue;
+
+        if (shardSize >= target && shard < numShards - 1) {
+            shard++;
+            shardSize = 0;
+        }
+
+        int head = 0, tail = 0;
+        queue[tail++] = seed;
+        partition->shardOf[seed] = shard;
+        shardSize++;
+
+        while (head < tail && (shardSize < target || shard == numShards - 1)) {
+            int u = queue[head++];
+            for (int v = 0; v < V; v++) {
+                if (!linked[u][v] || partition->shardOf[v] != -1)
+                    continue;
+                if (shardSize >= target && shard < numShards - 1)
+                    break;
+
+                partition->shardOf[v] = shard;
+                shardSize++;
+                queue[tail++] = v;
+            }
+        }
+    }
+    int shardCount = shard + 1;
+
+    for (int u = 0; u < V; u++) {
+        for (AdjListNode* pCrawl = network->adjList[u]; pCrawl; pCrawl = pCrawl->next) {
+            if (partition->shardOf[u] != partition->shardOf[pCrawl->dest]) {
+                partition->isBoundary[u] = true;
+                partition->isBoundary[pCrawl->dest] = true;
+            }
+        }
+    }
+
+    // Keep buffered output from being written again by the workers
+    fflush(stdout);
+
+    for (int s = 0; s < shardCount; s++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == -1) {
+            printf("Error: Could not create socket for region %d\n", s + 1);
+            freePartition(partition);
+            return NULL;
+        }
+
+        pid_t pid = fork();
+        if (pid == -1) {
+            printf("Error: Could not start worker for region %d\n", s + 1);
+            close(pair[0]);
+            close(pair[1]);
+            freePartition(partition);
+            return NULL;
+        }
+
+        if (pid == 0) {
+            // Only this region's socket stays open in the worker
+            close(pair[0]);
+            for (int i = 0; i < s; i++) {
+                close(partition->sockets[i]);
+            }
+            runRegionWorker(network, partition->shardOf, s, pair[1]);
+            _exit(0);
+        }
+
+        close(pair[1]);
+        partition->workers[s] = pid;
+        partition->sockets[s] = pair[0];
+        partition->numShards++;
+    }
+
+    // Overlay: boundary airports joined by their intra-region shortest paths
+    // and by the routes that cross between regions
+    partition->overlay = createFlightNetwork();
+    partition->overlay->numAirports = V;
+
+    RegionReply reply;
+    for (int u = 0; u < V; u++) {
+        if (!partition->isBoundary[u])
+            continue;
+
+        for (int v = 0; v < V; v++) {
+            if (v == u || !partition->isBoundary[v] ||
+                partition->shardOf[v] != partition->shardOf[u])
+                continue;
+
+            if (!queryRegion(partition, u, v, &reply)) {
+                freePartition(partition);
+                return NULL;
+            }
+            if (reply.distance == INF)
+                continue;
+
+            AdjListNode* newNode = createAdjListNode(v, reply.distance,
+                                                     reply.duration, reply.cost);
+            newNode->next = partition->overlay->adjList[u];
+            partition->overlay->adjList[u] = newNode;
+        }
+
+        for (AdjListNode* pCrawl = network->adjList[u]; pCrawl; pCrawl = pCrawl->next) {
+            if (partition->shardOf[pCrawl->dest] == partition->shardOf[u])
+                continue;
+
+            AdjListNode* newNode = createAdjListNode(pCrawl->dest, pCrawl->distance,
+                                                     pCrawl->duration, pCrawl->cost);
+            newNode->next = partition->overlay->adjList[u];
+            partition->overlay->adjList[u] = newNode;
+        }
+    }
+
+    return partition;
+}
+
+void displayPartition(PartitionedNetwork* partition, FlightNetwork* network) {
+    printf("\n=== Regions ===\n");
+
+    for (int s = 0; s < partition->numShards; s++) {
+        printf("Region %d:", s + 1);
+        for (int v = 0; v < partition->numAirports; v++) {
+            if (partition->shardOf[v] == s) {
+                printf(" %s%s", network->airports[v].code,
+                       partition->isBoundary[v] ? "*" : "");
+            }
+        }
+        printf("\n");
+    }
+    printf("(* = boundary airport)\n\n");
+}
+
+// Append the airports after `from` on its intra-region path to `to`.
+// Returns false if the region's worker could not be reached.
+bool appendRegionSegment(PartitionedNetwork* partition, int from, int to,
+                         int* path, int* length) {
+    RegionReply reply;
+
+    if (!queryRegion(partition, from, to, &reply))
+        return false;
+
+    for (int i = 1; i < reply.length; i++) {
+        path[(*length)++] = reply.path[i];
+    }
+    return true;
+}
+
+// Append the airports after `src` on the path to boundary airport b,
+// expanding each overlay hop inside a region back into its actual routes
+bool appendOverlayPath(PartitionedNetwork* partition, int* prev, int src, int b,
+                       int* path, int* length) {
+    if (prev[b] == -1)
+        return appendRegionSegment(partition, src, b, path, length);
+
+    if (!appendOverlayPath(partition, prev, src, prev[b], path, length))
+        return false;
+
+    if (partition->shardOf[prev[b]] == partition->shardOf[b])
+        return appendRegionSegment(partition, prev[b], b, path, length);
+
+    path[(*length)++] = b;
+    return true;
+}
+
+// Answer a query through the region workers: leave the source region through
+// one of its boundary airports, search the overlay, and enter the destination
+// region through one of its boundary airports. Returns false without printing
+// a route if a region worker could not be reached.
+bool findPartitionedRoute(PartitionedNetwork* partition, FlightNetwork* network,
+                          int src, int dest) {
+    int V = partition->numAirports;
+
+    int* dist = (int*)malloc(V * sizeof(int));
+    int* duration = (int*)malloc(V * sizeof(int));
+    int* cost = (int*)malloc(V * sizeof(int));
+
+    int* prev = (int*)malloc(V * sizeof(int));
+
+    // Each overlay hop expands to at most V airports
+    int* path = (int*)malloc((V + 1) * V * sizeof(int));
+    int length = 0;
+
+    bool ok = true;
+    RegionReply reply;
+    for (int v = 0; v < V; v++) {
+        dist[v] = INF;
+        duration[v] = INF;
+        cost[v] = INF;
+        prev[v] = -1;
+    }
+
+    for (int v = 0; v < V && ok; v++) {
+        if (partition->isBoundary[v] && partition->shardOf[v] == partition->shardOf[src]) {
+            ok = queryRegion(partition, src, v, &reply);
+            dist[v] = reply.distance;
+            duration[v] = reply.duration;
+            cost[v] = reply.cost;
+        }
+    }
+
+    int bestDist = INF;
+    int bestDuration = INF;
+    int bestCost = INF;
+    int via = -1;
+
+    if (ok) {
+        runDijkstra(partition->overlay, NULL, WEIGHT_DISTANCE, dist, duration, cost, prev, -1);
+
+        // A route within one region may not need the overlay at all
+        ok = queryRegion(partition, src, dest, &reply);
+        bestDist = reply.distance;
+        bestDuration = reply.duration;
+        bestCost = reply.cost;
+    }
+
+    for (int b = 0; b < V && ok; b++) {
+        if (dist[b] == INF || partition->shardOf[b] != partition->shardOf[dest])
+            continue;
+
+        ok = queryRegion(partition, b, dest, &reply);
+        if (!ok || reply.distance == INF)
+            continue;
+
+        if (dist[b] + reply.distance < bestDist) {
+            bestDist = dist[b] + reply.distance;
+            bestDuration = duration[b] + reply.duration;
+            bestCost = cost[b] + reply.cost;
+            via = b;
+        }
+    }
+
+    if (ok && bestDist != INF) {
+        if (via == -1) {
+            ok = appendRegionSegment(partition, src, dest, path, &length);
+        } else {
+            ok = appendOverlayPath(partition, prev, src, via, path, &length) &&
+                 appendRegionSegment(partition, via, dest, path, &length);
+        }
+    }
+
+    // On a worker failure nothing found so far can be trusted, so print no
+    // route and leave the caller to restart the regions
+    if (ok && bestDist == INF) {
+        printf("No path exists from %s to %s\n",
+               network->airports[src].code, network->airports[dest].code);
+    } else if (ok) {
+        printf("Optimal route from %s to %s:\n",
+               network->airports[src].code, network->airports[dest].code);
+        printf("Path: %s", network->airports[src].code);
+        for (int i = 0; i < length; i++) {
+            printf(" -> %s", network->airports[path[i]].code);
+        }
+        printf("\nTotal Distance: %d units\n", bestDist);
+        printf("Total Duration: %d minutes\n", bestDuration);
+        printf("Total Cost: %d units\n", bestCost);
+    }
+
+    free(dist);
+    free(duration);
+    free(cost);
+    free(prev);
+    free(path);
+
+    return ok;
+}
+
+// Build a copy of the network with every route the constraints allow
+// reversed, for lower bounds towards a destination
+FlightNetwork* createReverseNetwork(FlightNetwork* network, RouteConstraints* constraints) {
+    FlightNetwork* reverse = createFlightNetwork();
+    reverse->numAirports = network->numAirports;
+
+    for (int u = 0; u < network->numAirports; u++) {
+        for (AdjListNode* pCrawl = network->adjList[u]; pCrawl; pCrawl = pCrawl->next) {
+            int v = pCrawl->dest;
+            if (constraints->excluded[u] || constraints->excluded[v] ||
+                constraints->excludedRoute[u][v])
+                continue;
+
+            AdjListNode* newNode = createAdjListNode(u, pCrawl->distance,
+                                                     pCrawl->duration, pCrawl->cost);
+            newNode->next = reverse->adjList[v];
+            reverse->adjList[v] = newNode;
+        }
+    }
+
+    return reverse;
+}
+
+// Fill distBound, costBound and hopBound with the least total distance, cost
+// and number of flights of any route from each airport to dest, searching the
+// reversed network outwards from dest (INF if dest cannot be reached)
+void computeLowerBounds(FlightNetwork* reverse, int dest,
+                        int* distBound, int* costBound, int* hopBound) {
+    int V = reverse->numAirports;
+
+    RouteWeight weights[3] = {WEIGHT_DISTANCE, WEIGHT_COST, WEIGHT_FLIGHTS};
+    int* bounds[3] = {distBound, costBound, hopBound};
+
+    int* duration = (int*)malloc(V * sizeof(int));
+    int* cost = (int*)malloc(V * sizeof(int));
+    int* prev = (int*)malloc(V * sizeof(int));
+
+    for (int k = 0; k < 3; k++) {
+        for (int v = 0; v < V; v++) {
+            bounds[k][v] = INF;
+            duration[v] = INF;
+            cost[v] = INF;
+            prev[v] = -1;
+        }
+
+        bounds[k][dest] = 0;
+        duration[dest] = 0;
+        cost[dest] = 0;
+
+        runDijkstra(reverse, NULL, weights[k], bounds[k], duration, cost, prev, -1);
+    }
+
+    free(duration);
+    free(cost);
+    free(prev);
+}
+
+int addLabel(LabelQueue* queue, RouteLabel label) {
+    if (queue->numLabels == queue->labelCapacity) {
+        queue->labelCapacity *= 2;
+        queue->labels = (RouteLabel*)realloc(queue->labels,
+                                             queue->labelCapacity * sizeof(RouteLabel));
+    }
+
+    queue->labels[queue->numLabels] = label;
+    return queue->numLabels++;
+}
+
+void pushLabel(LabelQueue* queue, int index) {
+    if (queue->heapSize == queue->heapCapacity) {
+        queue->heapCapacity *= 2;
+        queue->heap = (int*)realloc(queue->heap, queue->heapCapacity * sizeof(int));
+    }
+
+    int i = queue->heapSize++;
+    queue->heap[i] = index;
+
+    while (i && queue->labels[queue->heap[i]].key <
+                queue->labels[queue->heap[(i - 1) / 2]].key) {
+        int temp = queue->heap[i];
+        queue->heap[i] = queue->heap[(i - 1) / 2];
+        queue->heap[(i - 1) / 2] = temp;
+
+        i = (i - 1) / 2;
+    }
+}
+
+int popLabel(LabelQueue* queue) {
+    int top = queue->heap[0];
+    queue->heap[0] = queue->heap[--queue->heapSize];
+
+    int i = 0;
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = 2 * i + 2;
+
+        if (left < queue->heapSize &&
+            queue->labels[queue->heap[left]].key < queue->labels[queue->heap[smallest]].key)
+            smallest = left;
+
+        if (right < queue->heapSize &&
+            queue->labels[queue->heap[right]].key < queue->labels[queue->heap[smallest]].key)
+            smallest = right;
+
+        if (smallest == i)
+            break;
+
+        int temp = queue->heap[i];
+        queue->heap[i] = queue->heap[smallest];
+        queue->heap[smallest] = temp;
+
+        i = smallest;
+    }
+
+    return top;
+}
+
+void printLabelPath(LabelQueue* queue, int index, FlightNetwork* network) {
+    RouteLabel* label = &queue->labels[index];
+
+    if (label->parent == -1) {
+        printf("%s", network->airports[label->airport].code);
+        return;
+    }
+
+    printLabelPath(queue, label->parent, network);
+    printf(" -> %s", network->airports[label->airport].code);
+}
+
+// Shortest route by distance that satisfies the stop limit, cost budget and
+// airport exclusions. Each airport can hold several labels (one per
+// non-dominated trade-off of distance, cost and stops), and labels are
+// expanded in order of distance plus the exact remaining distance, so the
+// first label to reach the destination is optimal. Labels that cannot meet
+// the stop limit or budget even along the best remaining route are dropped.
+void findConstrainedRoute(FlightNetwork* network, int src, int dest,
+                          RouteConstraints* constraints) {
+    int V = network->numAirports;
+
+    if (constraints->excluded[src] || constraints->excluded[dest]) {
+        printf("Error: Source or destination airport is excluded\n");
+        return;
+    }
+
+    bool allowed[100] = {false};
+    for (int v = 0; v < V; v++) {
+        allowed[v] = !constraints->excluded[v];
+    }
+
+    int maxHops = constraints->maxStops < 0 ? INF : constraints->maxStops + 1;
+
+    int* distBound = (int*)malloc(V * sizeof(int));
+    int* costBound = (int*)malloc(V * sizeof(int));
+    int* hopBound = (int*)malloc(V * sizeof(int));
+
+    FlightNetwork* reverse = createReverseNetwork(network, constraints);
+    computeLowerBounds(reverse, dest, distBound, costBound, hopBound);
+    freeNetwork(reverse);
+
+    int* firstLabel = (int*)malloc(V * sizeof(int));
+    for (int v = 0; v < V; v++) {
+        firstLabel[v] = -1;
+    }
+
+    LabelQueue queue;
+    queue.labelCapacity = 64;
+    queue.numLabels = 0;
+    queue.labels = (RouteLabel*)malloc(queue.labelCapacity * sizeof(RouteLabel));
+    queue.heapCapacity = 64;
+    queue.heapSize = 0;
+    queue.heap = (int*)malloc(queue.heapCapacity * sizeof(int));
+
+    int found = -1;
+
+    if (distBound[src] != INF && costBound[src] <= constraints->maxCost &&
+        hopBound[src] <= maxHops) {
+        RouteLabel start = {src, 0, 0, 0, 0, -1, -1, distBound[src]};
+        firstLabel[src] = addLabel(&queue, start);
+        pushLabel(&queue, firstLabel[src]);
+    }
+
+    while (queue.heapSize > 0) {
+        int index = popLabel(&queue);
+        RouteLabel label = queue.labels[index];
+
+        if (label.airport == dest) {
+            found = index;
+            break;
+        }
+
+        AdjListNode* pCrawl = network->adjList[label.airport];
+        while (pCrawl != NULL) {
+            int v = pCrawl->dest;
+            RouteLabel next = {v,
+                               label.distance + pCrawl->distance,
+                               label.duration + pCrawl->duration,
+                               label.cost + pCrawl->cost,
+                               label.hops + 1,
+                               index, -1, 0};
+            pCrawl = pCrawl->next;
+
+            // Bounds are INF for excluded airports and dead ends
+            if (!allowed[v] || constraints->excludedRoute[label.airport][v] ||
+                distBound[v] == INF ||
+                next.cost > constraints->maxCost - costBound[v] ||
+                next.hops > maxHops - hopBound[v])
+                continue;
+
+            bool dominated = false;
+            for (int j = firstLabel[v]; j != -1; j = queue.labels[j].next) {
+                RouteLabel* other = &queue.labels[j];
+                if (other->distance <= next.distance && other->cost <= next.cost &&
+                    other->hops <= next.hops) {
+                    dominated = true;
+                    break;
+                }
+            }
+            if (dominated)
+                continue;
+
+            next.key = next.distance + distBound[v];
+            next.next = firstLabel[v];
+            firstLabel[v] = addLabel(&queue, next);
+            pushLabel(&queue, firstLabel[v]);
+        }
+    }
+
+    if (found == -1) {
+        printf("No route from %s to %s satisfies the constraints\n",
+               network->airports[src].code, network->airports[dest].code);
+    } else {
+        RouteLabel* label = &queue.labels[found];
+
+        printf("Optimal route from %s to %s:\n",
+               network->airports[src].code, network->airports[dest].code);
+        printf("Path: ");
+        printLabelPath(&queue, found, network);
+        printf("\nTotal Distance: %d units\n", label->distance);
+        printf("Total Duration: %d minutes\n", label->duration);
+        printf("Total Cost: %d units\n", label->cost);
+        // A route from an airport to itself takes no flights
+        printf("Stops: %d\n", label->hops > 0 ? label->hops - 1 : 0);
+    }
+
+    free(distBound);
+    free(costBound);
+    free(hopBound);
+    free(firstLabel);
+    free(queue.labels);
+    free(queue.heap);
 }
 
 void findMinCostRoute(FlightNetwork* network, int src, int dest) {
@@ -552,6 +1384,8 @@ int main() {
     displayAllAirports(network);
     displayAllRoutes(network);
 
+    PartitionedNetwork* partition = NULL;
+
     char choice;
     do {
         char srcCode[10], destCode[10];
@@ -563,8 +1397,10 @@ int main() {
         printf("3. Display all routes\n");
         printf("4. Add a new route\n");
         printf("5. Add a new airport\n");
-        printf("6. Exit\n");
-        printf("Enter your choice (1-6): ");
+        printf("6. Find route using regional partitions\n");
+        printf("7. Find route with constraints\n");
+        printf("8. Exit\n");
+        printf("Enter your choice (1-8): ");
         scanf(" %c", &choice);
 
         switch (choice) {
@@ -637,6 +1473,12 @@ int main() {
                 // Add the route
                 addRoute(network, srcCode, destCode, distance, duration, cost);
                 printf("Route from %s to %s added successfully!\n", srcCode, destCode);
+
+                // The regions no longer match the network
+                if (partition != NULL) {
+                    freePartition(partition);
+                    partition = NULL;
+                }
                 break;
             }
 
@@ -677,11 +1519,167 @@ int main() {
                 int index = addAirport(network, code, name);
                 if (index != -1) {
                     printf("Airport %s (%s) added successfully!\n", code, name);
+
+                    // The regions no longer match the network
+                    if (partition != NULL) {
+                        freePartition(partition);
+                        partition = NULL;
+                    }
+                }
+                break;
+            }
+
+            case '6': {
+                int numShards;
+
+                printf("\nEnter source airport code: ");
+                scanf("%s", srcCode);
+                printf("Enter destination airport code: ");
+                scanf("%s", destCode);
+
+                // Convert to uppercase
+                toUpperCase(srcCode);
+                toUpperCase(destCode);
+
+                srcIndex = findAirportIndex(network, srcCode);
+                destIndex = findAirportIndex(network, destCode);
+
+                if (srcIndex == -1 || destIndex == -1) {
+                    printf("Invalid source or destination airport code\n");
+                    break;
+                }
+
+                printf("Enter number of regions: ");
+                if (scanf("%d", &numShards) != 1) {
+                    printf("Error: Invalid number of regions.\n");
+                    break;
+                }
+
+                // Regions are kept between queries until the count changes
+                if (partition != NULL && partition->requestedShards != numShards) {
+                    freePartition(partition);
+                    partition = NULL;
+                }
+
+                if (partition == NULL) {
+                    partition = partitionNetwork(network, numShards);
+                    if (partition == NULL) {
+                        break;
+                    }
+                }
+
+                displayPartition(partition, network);
+                printf("=== Finding optimal route across regions ===\n");
+                if (!findPartitionedRoute(partition, network, srcIndex, destIndex)) {
+                    printf("Regions will be rebuilt on the next query.\n");
+                    freePartition(partition);
+                    partition = NULL;
+                }
+                break;
+            }
+
+            case '7': {
+                RouteConstraints constraints;
+                int numExcluded;
+                bool valid = true;
+
+                printf("\nEnter source airport code: ");
+                scanf("%s", srcCode);
+                printf("Enter destination airport code: ");
+                scanf("%s", destCode);
+
+                // Convert to uppercase
+                toUpperCase(srcCode);
+                toUpperCase(destCode);
+
+                srcIndex = findAirportIndex(network, srcCode);
+                destIndex = findAirportIndex(network, destCode);
+
+                if (srcIndex == -1 || destIndex == -1) {
+                    printf("Invalid source or destination airport code\n");
+                    break;
+                }
+
+                printf("Enter maximum number of stops (-1 for no limit): ");
+                if (scanf("%d", &constraints.maxStops) != 1) {
+                    printf("Error: Invalid number of stops.\n");
+                    break;
+                }
+
+                printf("Enter cost budget (0 for no budget): ");
+                if (scanf("%d", &constraints.maxCost) != 1 || constraints.maxCost < 0) {
+                    printf("Error: Cost budget must be zero or a positive value.\n");
+                    break;
+                }
+                if (constraints.maxCost == 0) {
+                    constraints.maxCost = INF;
+                }
+
+                for (int i = 0; i < 100; i++) {
+                    constraints.excluded[i] = false;
+                    for (int j = 0; j < 100; j++) {
+                        constraints.excludedRoute[i][j] = false;
+                    }
+                }
+
+                printf("Enter number of airports to avoid: ");
+                if (scanf("%d", &numExcluded) != 1 || numExcluded < 0) {
+                    printf("Error: Invalid number of airports.\n");
+                    break;
+                }
+
+                for (int i = 0; i < numExcluded; i++) {
+                    char code[10];
+
+                    printf("Enter airport code to avoid: ");
+                    scanf("%s", code);
+                    toUpperCase(code);
+
+                    int index = findAirportIndex(network, code);
+                    if (index == -1) {
+                        printf("Error: Airport %s not found.\n", code);
+                        valid = false;
+                        break;
+                    }
+                    constraints.excluded[index] = true;
+                }
+                if (!valid) {
+                    break;
+                }
+
+                printf("Enter number of routes to avoid: ");
+                if (scanf("%d", &numExcluded) != 1 || numExcluded < 0) {
+                    printf("Error: Invalid number of routes.\n");
+                    break;
                 }
+
+                for (int i = 0; i < numExcluded; i++) {
+                    char from[10], to[10];
+
+                    printf("Enter route to avoid (source and destination codes): ");
+                    scanf("%s %s", from, to);
+                    toUpperCase(from);
+                    toUpperCase(to);
+
+                    int fromIndex = findAirportIndex(network, from);
+                    int toIndex = findAirportIndex(network, to);
+                    if (fromIndex == -1 || toIndex == -1) {
+                        printf("Error: One or both airports not found.\n");
+                        valid = false;
+                        break;
+                    }
+                    constraints.excludedRoute[fromIndex][toIndex] = true;
+                }
+                if (!valid) {
+                    break;
+                }
+
+                printf("\n=== Finding optimal route within constraints ===\n");
+                findConstrainedRoute(network, srcIndex, destIndex, &constraints);
                 break;
             }
 
-            case '6':
+            case '8':
                 printf("Saving network data and exiting...\n");
                 saveNetworkToFile(network, dataFile);
                 printf("Goodbye!\n");
@@ -691,8 +1689,11 @@ int main() {
                 printf("Invalid choice. Please try again.\n");
         }
 
-    } while (choice != '6');
+    } while (choice != '8');
 
+    if (partition != NULL) {
+        freePartition(partition);
+    }
     freeNetwork(network);
 
     return 0;